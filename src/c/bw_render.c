@@ -0,0 +1,77 @@
+#include <pebble.h>
+#include <pebble-fctx/fctx.h>
+#include "logging.h"
+#include "bw_render.h"
+
+#ifdef PBL_BW
+// Ordered dither masks, indexed by row parity. Bit 0 is the leftmost pixel of each byte.
+static const uint8_t SOLID[2] = { 0xff, 0xff };
+static const uint8_t HALF[2] = { 0x55, 0xaa };
+static const uint8_t QUARTER[2] = { 0x11, 0x44 };
+
+static inline void write_byte(uint8_t *dst, uint8_t mask, bool white) {
+    if (white) {
+        *dst |= mask;
+    } else {
+        *dst &= ~mask;
+    }
+}
+
+// Replaces fctx_end_fill on 1-bit platforms. The outline edges fctx plotted into its flag buffer are
+// resolved eight pixels at a time with an even-odd prefix XOR and written straight into the frame buffer,
+// so interior spans cost one store per byte and fades are dithered instead of blended.
+//
+// This reads FContext internals that fctx does not document: flag_bounds, extent_min/extent_max in screen
+// fixed point, and a 1 bit per pixel, LSB first flag_buffer holding even-odd edge toggles. That matches
+// pebble-fctx 1.6.1, which package.json pins exactly; re-check this function before upgrading it.
+void bw_render_end_fill(FContext *fctx, GBitmap *frame_buffer, GColor color, BwShade shade) {
+    log_func();
+    if (!frame_buffer) {
+        fctx_end_fill(fctx);
+        return;
+    }
+    bool gray = gcolor_equal(color, GColorDarkGray) || gcolor_equal(color, GColorLightGray);
+    bool white = gray || gcolor_equal(color, GColorWhite);
+    const uint8_t *pattern = shade == BwShadeSolid ? (gray ? HALF : SOLID) : (gray ? QUARTER : HALF);
+
+    GRect bounds = fctx->flag_bounds;
+    int16_t row_min = FIXED_TO_INT(fctx->extent_min.y);
+    int16_t row_max = FIXED_TO_INT(fctx->extent_max.y);
+    int16_t col_min = FIXED_TO_INT(fctx->extent_min.x);
+    int16_t col_max = FIXED_TO_INT(fctx->extent_max.x);
+    if (row_min < 0) row_min = 0;
+    if (col_min < 0) col_min = 0;
+    if (row_max >= bounds.size.h) row_max = bounds.size.h - 1;
+    if (col_max >= bounds.size.w) col_max = bounds.size.w - 1;
+
+    uint8_t *src_data = gbitmap_get_data(fctx->flag_buffer);
+    uint16_t src_stride = gbitmap_get_bytes_per_row(fctx->flag_buffer);
+    uint8_t *dst_data = gbitmap_get_data(frame_buffer);
+    uint16_t dst_stride = gbitmap_get_bytes_per_row(frame_buffer);
+    int16_t byte_min = col_min >> 3;
+    int16_t byte_max = col_max >> 3;
+
+    for (int16_t y = row_min; y <= row_max; y++) {
+        uint8_t *src = src_data + y * src_stride;
+        uint8_t *dst = dst_data + y * dst_stride;
+        uint8_t dither = pattern[y & 1];
+        bool inside = false;
+        for (int16_t x = byte_min; x <= byte_max; x++) {
+            uint8_t flags = src[x];
+            if (flags == 0) {
+                if (inside) write_byte(&dst[x], dither, white);
+                continue;
+            }
+            src[x] = 0;
+
+            uint8_t mask = flags;
+            mask ^= mask << 1;
+            mask ^= mask << 2;
+            mask ^= mask << 4;
+            if (inside) mask = ~mask;
+            inside = mask & 0x80;
+            write_byte(&dst[x], mask & dither, white);
+        }
+    }
+}
+#endif
@@ -0,0 +1,12 @@
+#pragma once
+#include <pebble.h>
+#include <pebble-fctx/fctx.h>
+
+#ifdef PBL_BW
+typedef enum {
+    BwShadeSolid,
+    BwShadeFaded
+} BwShade;
+
+void bw_render_end_fill(FContext *fctx, GBitmap *frame_buffer, GColor color, BwShade shade);
+#endif
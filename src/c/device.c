@@ -6,18 +6,53 @@
 #include "fonts.h"
 #include "enamel.h"
 #include "colors.h"
+#include "focus.h"
 #include "minute_layer.h"
 #include "hour_layer.h"
 #include "battery_layer.h"
+#include "steps_layer.h"
 
 static Window *s_window;
 static MinuteLayer *s_minute_layer;
 static HourLayer *s_hour_layer;
 static BatteryLayer *s_battery_layer;
+#ifdef PBL_HEALTH
+static StepsLayer *s_steps_layer;
+#endif
 
 static EventHandle s_settings_event_handle;
 static EventHandle s_connection_event_handle;
 
+static GRect get_layout_bounds(Layer *root_layer) {
+    log_func();
+#if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+    GRect bounds = layer_get_unobstructed_bounds(root_layer);
+#else
+    GRect bounds = layer_get_bounds(root_layer);
+#endif
+#ifdef PBL_RECT
+    int16_t diff = bounds.size.h - bounds.size.w;
+    bounds = GRect(bounds.origin.x - diff, bounds.origin.y, bounds.size.w + diff, bounds.size.h);
+#endif
+    return bounds;
+}
+
+#ifdef PBL_HEALTH
+static void update_steps_layer(void) {
+    log_func();
+    bool enabled = enamel_get_ENABLE_HEALTH() && enamel_get_SHOW_STEPS();
+    if (enabled && !s_steps_layer) {
+        Layer *root_layer = window_get_root_layer(s_window);
+        s_steps_layer = steps_layer_create(get_layout_bounds(root_layer));
+        layer_add_child(root_layer, s_steps_layer);
+    } else if (!enabled && s_steps_layer) {
+        layer_remove_from_parent(s_steps_layer);
+        steps_layer_destroy(s_steps_layer);
+        s_steps_layer = NULL;
+    }
+}
+#endif
+
 static void settings_handler(void *context) {
     log_func();
     window_set_background_color(s_window, get_background_color());
@@ -26,6 +61,7 @@ static void settings_handler(void *context) {
 #ifdef PBL_HEALTH
     connection_vibes_enable_health(enamel_get_ENABLE_HEALTH());
     hourly_vibes_enable_health(enamel_get_ENABLE_HEALTH());
+    update_steps_layer();
 #endif
 }
 
@@ -34,14 +70,24 @@ static void connection_handler(bool connected, void *context) {
     layer_mark_dirty(context);
 }
 
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+static void unobstructed_did_change_handler(void *context) {
+    log_func();
+    GRect bounds = get_layout_bounds(context);
+    layer_set_frame(s_minute_layer, bounds);
+    layer_set_frame(s_hour_layer, bounds);
+    layer_set_frame(s_battery_layer, bounds);
+#ifdef PBL_HEALTH
+    if (s_steps_layer) layer_set_frame(s_steps_layer, bounds);
+#endif
+}
+#endif
+
 static void window_load(Window *window) {
     log_func();
     Layer *root_layer = window_get_root_layer(window);
-    GRect bounds = layer_get_bounds(root_layer);
-#ifdef PBL_RECT
-    int16_t diff = bounds.size.h - bounds.size.w;
-    bounds = GRect(bounds.origin.x - diff, bounds.origin.y, bounds.size.w + diff, bounds.size.h);
-#endif
+    GRect bounds = get_layout_bounds(root_layer);
+    focus_init(root_layer);
 
     s_minute_layer = minute_layer_create(bounds);
     layer_add_child(root_layer, s_minute_layer);
@@ -58,16 +104,32 @@ static void window_load(Window *window) {
     s_connection_event_handle = events_connection_service_subscribe_context((EventConnectionHandlers) {
         .pebble_app_connection_handler = connection_handler
     }, root_layer);
+
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    unobstructed_area_service_subscribe((UnobstructedAreaHandlers) {
+        .did_change = unobstructed_did_change_handler
+    }, root_layer);
+#endif
 }
 
 static void window_unload(Window *window) {
     log_func();
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    unobstructed_area_service_unsubscribe();
+#endif
     events_connection_service_unsubscribe(s_connection_event_handle);
     enamel_settings_received_unsubscribe(s_settings_event_handle);
 
+#ifdef PBL_HEALTH
+    if (s_steps_layer) {
+        steps_layer_destroy(s_steps_layer);
+        s_steps_layer = NULL;
+    }
+#endif
     battery_layer_destroy(s_battery_layer);
     hour_layer_destroy(s_hour_layer);
     minute_layer_destroy(s_minute_layer);
+    focus_deinit();
 }
 
 static void init(void) {
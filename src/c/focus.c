@@ -0,0 +1,90 @@
+#include <pebble.h>
+#include <@smallstoneapps/linked-list/linked-list.h>
+#include "logging.h"
+#include "focus.h"
+
+typedef struct {
+    FocusHandler handler;
+    void *context;
+} Subscriber;
+
+static bool s_focused;
+static Layer *s_layer;
+static LinkedRoot *s_subscribers;
+
+static bool list_notify_callback(void *object, void *context) {
+    log_func();
+    Subscriber *subscriber = (Subscriber *) object;
+    subscriber->handler(subscriber->context);
+    return true;
+}
+
+static void will_focus_handler(bool in_focus) {
+    log_func();
+    if (!in_focus) {
+        s_focused = false;
+        animation_unschedule_all();
+        layer_set_hidden(s_layer, true);
+    }
+}
+
+// Animations were cut short when focus was lost, so subscribers resync their values before the layer is shown.
+static void did_focus_handler(bool in_focus) {
+    log_func();
+    if (in_focus) {
+        s_focused = true;
+        linked_list_foreach(s_subscribers, list_notify_callback, NULL);
+        layer_set_hidden(s_layer, false);
+        layer_mark_dirty(s_layer);
+    }
+}
+
+void focus_init(Layer *layer) {
+    log_func();
+    s_layer = layer;
+    s_subscribers = linked_list_create_root();
+    s_focused = app_focus_service_peek_in_focus();
+    app_focus_service_subscribe_handlers((AppFocusHandlers) {
+        .will_focus = will_focus_handler,
+        .did_focus = did_focus_handler
+    });
+}
+
+static bool list_destroy_callback(void *object, void *context) {
+    log_func();
+    free(object);
+    return true;
+}
+
+void focus_deinit(void) {
+    log_func();
+    app_focus_service_unsubscribe();
+    linked_list_foreach(s_subscribers, list_destroy_callback, NULL);
+    linked_list_clear(s_subscribers);
+    free(s_subscribers);
+    s_subscribers = NULL;
+    s_layer = NULL;
+}
+
+bool focus_is_focused(void) {
+    log_func();
+    return s_focused;
+}
+
+FocusHandle focus_subscribe(FocusHandler handler, void *context) {
+    log_func();
+    Subscriber *subscriber = malloc(sizeof(Subscriber));
+    subscriber->handler = handler;
+    subscriber->context = context;
+    linked_list_append(s_subscribers, subscriber);
+    return subscriber;
+}
+
+void focus_unsubscribe(FocusHandle handle) {
+    log_func();
+    int16_t index = linked_list_find(s_subscribers, handle);
+    if (index != -1) {
+        linked_list_remove(s_subscribers, index);
+        free(handle);
+    }
+}
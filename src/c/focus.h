@@ -0,0 +1,11 @@
+#pragma once
+#include <pebble.h>
+
+typedef void (*FocusHandler)(void *context);
+typedef void *FocusHandle;
+
+void focus_init(Layer *layer);
+void focus_deinit(void);
+bool focus_is_focused(void);
+FocusHandle focus_subscribe(FocusHandler handler, void *context);
+void focus_unsubscribe(FocusHandle handle);
@@ -0,0 +1,280 @@
+#include <pebble.h>
+#include <pebble-fctx/fctx.h>
+#include <pebble-fctx/ffont.h>
+#include "logging.h"
+#include "fonts.h"
+#include "colors.h"
+#include "focus.h"
+#include "bw_render.h"
+#include "ring_layer.h"
+
+// Idle detail per platform. aplite and diorite have the slowest CPUs and emery the most pixels, so they always
+// use quads. basalt and chalk keep the glyph ticks while idle and drop to quads while the ring is animating.
+#ifndef RING_DETAIL
+#if defined(PBL_PLATFORM_BASALT) || defined(PBL_PLATFORM_CHALK)
+#define RING_DETAIL RingDetailFull
+#else
+#define RING_DETAIL RingDetailQuad
+#endif
+#endif
+
+#ifndef RING_DETAIL_ANIMATING
+#define RING_DETAIL_ANIMATING RingDetailQuad
+#endif
+
+// Tick quad in font units (1000 per em), from the hyphen glyph right aligned and vertically centered.
+static const int16_t TICK_LEFT = -350;
+static const int16_t TICK_RIGHT = -70;
+static const int16_t TICK_HALF_HEIGHT = 70;
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+} TickPoint;
+
+typedef struct {
+    const RingDescriptor *descriptor;
+    FFont *font;
+    int16_t value;
+    Animation *animation;
+    uint8_t animations;
+    GSize tick_size;
+    TickPoint *ticks;
+    uint32_t data[];
+} Data;
+
+static FPoint rotate(int32_t x, int32_t y, int32_t angle) {
+    int32_t sine = sin_lookup(angle);
+    int32_t cosine = cos_lookup(angle);
+    return (FPoint) { (x * cosine - y * sine) / TRIG_MAX_RATIO, (x * sine + y * cosine) / TRIG_MAX_RATIO };
+}
+
+// Tick geometry depends only on the slot and the layer size, not on the value, so every slot's quad is
+// transformed once per layout and reused until the bounds change.
+static bool update_ticks(Data *data, GRect bounds, GRect rect, FPoint offset, int16_t em_height) {
+    log_func();
+    const RingDescriptor *ring = data->descriptor;
+    if (data->ticks && gsize_equal(&data->tick_size, &bounds.size)) return true;
+    if (!data->ticks) data->ticks = malloc(ring->positions * 4 * sizeof(TickPoint));
+    if (!data->ticks) return false;
+    data->tick_size = bounds.size;
+
+    int32_t left = TICK_LEFT * em_height * FIXED_POINT_SCALE / 1000;
+    int32_t right = TICK_RIGHT * em_height * FIXED_POINT_SCALE / 1000;
+    int32_t half_height = TICK_HALF_HEIGHT * em_height * FIXED_POINT_SCALE / 1000;
+    int16_t quarter = ring->positions / 4;
+    for (int k = 0; k < ring->positions; k++) {
+        int32_t rot_angle = ring->direction * k * TRIG_MAX_ANGLE / ring->positions;
+        int32_t point_angle = ring->direction * (k - quarter) * TRIG_MAX_ANGLE / ring->positions;
+        GPoint p = gpoint_from_polar(rect, PBL_IF_RECT_ELSE(GOvalScaleModeFillCircle, GOvalScaleModeFitCircle), point_angle);
+        FPoint origin = fpoint_add(offset, g2fpoint(p));
+
+        FPoint corners[] = {
+            rotate(left, -half_height, rot_angle),
+            rotate(right, -half_height, rot_angle),
+            rotate(right, half_height, rot_angle),
+            rotate(left, half_height, rot_angle)
+        };
+        TickPoint *quad = &data->ticks[k * 4];
+        for (int j = 0; j < 4; j++) {
+            quad[j] = (TickPoint) { origin.x + corners[j].x, origin.y + corners[j].y };
+        }
+    }
+    return true;
+}
+
+static void draw_tick(FContext *fctx, TickPoint *quad) {
+    fctx_move_to(fctx, (FPoint) { quad[0].x, quad[0].y });
+    fctx_line_to(fctx, (FPoint) { quad[1].x, quad[1].y });
+    fctx_line_to(fctx, (FPoint) { quad[2].x, quad[2].y });
+    fctx_line_to(fctx, (FPoint) { quad[3].x, quad[3].y });
+    fctx_close_path(fctx);
+}
+
+static void update_proc(Layer *this, GContext *ctx) {
+    log_func();
+    GRect bounds = layer_get_bounds(this);
+    Data *data = layer_get_data(this);
+    const RingDescriptor *ring = data->descriptor;
+    int16_t value = data->value;
+
+    FContext fctx;
+    fctx_init_context(&fctx, ctx);
+#ifdef PBL_BW
+    GColor color = get_foreground_color();
+    BwShade shade = BwShadeSolid;
+    GBitmap *frame_buffer = graphics_capture_frame_buffer(ctx);
+#endif
+
+    int16_t font_size = bounds.size.w / ring->font_divisor;
+    int16_t em_height = 0;
+    fctx_set_color_bias(&fctx, 0);
+    fctx_set_fill_color(&fctx, get_foreground_color());
+
+    FPoint offset = (FPoint) { ring->offset * font_size * FIXED_POINT_SCALE / 10, 0 };
+    GRect rect = grect_crop(bounds, ring->inset * font_size / 10);
+    int16_t quarter = ring->positions / 4;
+
+    RingDetail detail = data->animations > 0 ? RING_DETAIL_ANIMATING : RING_DETAIL;
+    bool quads = ring->ticks && detail != RingDetailFull && update_ticks(data, bounds, rect, offset, font_size - 4);
+
+    for (int k = 0; k < ring->positions; k++) {
+        int i = value + ring->direction * k;
+        bool label = i % ring->label_interval == 0;
+        if (!label && quads) {
+            fctx_begin_fill(&fctx);
+            fctx_set_scale(&fctx, FPointOne, FPointOne);
+            fctx_set_rotation(&fctx, 0);
+            fctx_set_offset(&fctx, FPointI(0, 0));
+            em_height = 0;
+            draw_tick(&fctx, &data->ticks[k * 4]);
+#ifdef PBL_COLOR
+            fctx_end_fill(&fctx);
+#else
+            bw_render_end_fill(&fctx, frame_buffer, color, shade);
+#endif
+        } else if (label || ring->ticks) {
+            fctx_begin_fill(&fctx);
+
+            int32_t rot_angle = ring->direction * k * TRIG_MAX_ANGLE / ring->positions;
+            fctx_set_rotation(&fctx, rot_angle);
+
+            int32_t point_angle = ring->direction * (k - quarter) * TRIG_MAX_ANGLE / ring->positions;
+            GPoint p = gpoint_from_polar(rect, PBL_IF_RECT_ELSE(GOvalScaleModeFillCircle, GOvalScaleModeFitCircle), point_angle);
+            fctx_set_offset(&fctx, fpoint_add(offset, g2fpoint(p)));
+
+            int16_t size = label ? font_size : font_size - 4;
+            if (size != em_height) {
+                fctx_set_text_em_height(&fctx, data->font, size);
+                em_height = size;
+            }
+
+            if (label) {
+                char s[4];
+                ring->format(s, sizeof(s), i);
+                fctx_draw_string(&fctx, s, data->font, ring->alignment, FTextAnchorMiddle);
+            } else {
+                fctx_draw_string(&fctx, "-", data->font, ring->alignment, FTextAnchorMiddle);
+            }
+
+#ifdef PBL_COLOR
+            fctx_end_fill(&fctx);
+#else
+            bw_render_end_fill(&fctx, frame_buffer, color, shade);
+#endif
+        }
+#ifdef PBL_COLOR
+        fctx_set_color_bias(&fctx, -3);
+#else
+        shade = BwShadeFaded;
+#endif
+    }
+
+#ifdef PBL_BW
+    if (frame_buffer) graphics_release_frame_buffer(ctx, frame_buffer);
+#endif
+    fctx_deinit_context(&fctx);
+}
+
+static void animation_setup(Animation *animation) {
+    log_func();
+    Layer *subject;
+    if (property_animation_get_subject((PropertyAnimation *) animation, (void **) &subject)) {
+        ((Data *) layer_get_data(subject))->animations++;
+    }
+}
+
+// The last frame of an animation was drawn at RING_DETAIL_ANIMATING, so redraw at idle detail once it ends.
+static void animation_teardown(Animation *animation) {
+    log_func();
+    Layer *subject;
+    if (property_animation_get_subject((PropertyAnimation *) animation, (void **) &subject)) {
+        Data *data = layer_get_data(subject);
+        if (data->animation == animation) data->animation = NULL;
+        if (data->animations > 0 && --data->animations == 0 && RING_DETAIL != RING_DETAIL_ANIMATING) {
+            layer_mark_dirty(subject);
+        }
+    }
+}
+
+static void value_setter(void *subject, int16_t value) {
+    log_func();
+    ((Data *) layer_get_data(subject))->value = value;
+    layer_mark_dirty(subject);
+}
+
+static int16_t value_getter(void *subject) {
+    log_func();
+    return ((Data *) layer_get_data(subject))->value;
+}
+
+static const PropertyAnimationImplementation animation_impl = {
+    .base = {
+        .setup = animation_setup,
+        .update = (AnimationUpdateImplementation)  property_animation_update_int16,
+        .teardown = animation_teardown
+    },
+    .accessors = {
+        .setter = { .int16 = value_setter },
+        .getter = { .int16 = value_getter }
+    }
+};
+
+RingLayer *ring_layer_create(GRect frame, const RingDescriptor *descriptor, size_t data_size) {
+    log_func();
+    RingLayer *this = layer_create_with_data(frame, sizeof(Data) + data_size);
+    layer_set_update_proc(this, update_proc);
+    Data *data = layer_get_data(this);
+
+    data->descriptor = descriptor;
+    data->font = fonts_get(RESOURCE_ID_LECO_FFONT);
+    data->animation = NULL;
+    data->animations = 0;
+    data->tick_size = GSizeZero;
+    data->ticks = NULL;
+
+    return this;
+}
+
+void ring_layer_destroy(RingLayer *this) {
+    log_func();
+    Data *data = layer_get_data(this);
+    if (data->animation) animation_unschedule(data->animation);
+    free(data->ticks);
+    layer_destroy(this);
+}
+
+void *ring_layer_get_data(RingLayer *this) {
+    log_func();
+    return ((Data *) layer_get_data(this))->data;
+}
+
+void ring_layer_set_value(RingLayer *this, int16_t value) {
+    log_func();
+    value_setter(this, value);
+}
+
+void ring_layer_format_percent(char *buffer, size_t size, int position) {
+    snprintf(buffer, size, "%d", position > 100 ? position - 100 : position);
+}
+
+void ring_layer_animate_to(RingLayer *this, int16_t to) {
+    log_func();
+    Data *data = layer_get_data(this);
+    if (data->animation) animation_unschedule(data->animation);
+    if (focus_is_focused()) {
+        int16_t from = value_getter(this);
+        PropertyAnimation *animation = property_animation_create(&animation_impl, this, NULL, NULL);
+        property_animation_set_from_int16(animation, &from);
+        property_animation_set_to_int16(animation, &to);
+        data->animation = property_animation_get_animation(animation);
+        animation_schedule(data->animation);
+    } else {
+        value_setter(this, to);
+    }
+}
+
+PropertyAnimation *ring_layer_property_animation_create(RingLayer *this) {
+    log_func();
+    return property_animation_create(&animation_impl, this, NULL, NULL);
+}
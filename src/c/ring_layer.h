@@ -0,0 +1,31 @@
+#pragma once
+#include <pebble.h>
+
+typedef Layer RingLayer;
+
+typedef enum {
+    RingDetailFull,     // ticks are drawn from the font outline
+    RingDetailQuad      // ticks are drawn as precomputed quads
+} RingDetail;
+
+typedef void (*RingLabelFormatter)(char *buffer, size_t size, int position);
+
+typedef struct {
+    int16_t positions;          // positions around the ring
+    int16_t label_interval;     // a label is drawn where position % label_interval == 0
+    int8_t direction;           // -1 counts down from the value, 1 counts up
+    int16_t font_divisor;       // font size is the layer width divided by this
+    int16_t inset;              // ring inset in tenths of the font size
+    int16_t offset;             // horizontal label offset in tenths of the font size
+    bool ticks;                 // draw a tick at positions without a label
+    GTextAlignment alignment;
+    RingLabelFormatter format;
+} RingDescriptor;
+
+RingLayer *ring_layer_create(GRect frame, const RingDescriptor *descriptor, size_t data_size);
+void ring_layer_destroy(RingLayer *this);
+void *ring_layer_get_data(RingLayer *this);
+void ring_layer_set_value(RingLayer *this, int16_t value);
+void ring_layer_animate_to(RingLayer *this, int16_t to);
+PropertyAnimation *ring_layer_property_animation_create(RingLayer *this);
+void ring_layer_format_percent(char *buffer, size_t size, int position);
@@ -0,0 +1,97 @@
+#include <pebble.h>
+#include <pebble-events/pebble-events.h>
+#include "logging.h"
+#include "focus.h"
+#include "ring_layer.h"
+#include "steps_layer.h"
+
+#ifdef PBL_HEALTH
+typedef struct {
+    time_t today;
+    HealthValue steps;
+    HealthValue goal;
+    int16_t bucket;
+    EventHandle health_event_handle;
+    FocusHandle focus_handle;
+} Data;
+
+static const RingDescriptor ring = {
+    .positions = 100,
+    .label_interval = 10,
+    .direction = 1,
+    .font_divisor = PBL_IF_ROUND_ELSE(20, 18),
+    .inset = PBL_IF_ROUND_ELSE(76, 67),
+    .offset = PBL_IF_RECT_ELSE(-19, 0),
+    .ticks = false,
+    .alignment = GTextAlignmentLeft,
+    .format = ring_layer_format_percent
+};
+
+static HealthValue sum_today(HealthMetric metric) {
+    log_func();
+    time_t start = time_start_of_today();
+    if (!(health_service_metric_accessible(metric, start, time(NULL)) & HealthServiceAccessibilityMaskAvailable)) return 0;
+    return health_service_sum_today(metric);
+}
+
+// The goal is the typical step count for a whole day like today, which only changes once per day.
+static void update_goal(Data *data) {
+    log_func();
+    data->today = time_start_of_today();
+    data->goal = health_service_sum_averaged(HealthMetricStepCount, data->today, data->today + SECONDS_PER_DAY,
+        HealthServiceTimeScopeDailyWeekdayOrWeekend);
+}
+
+static int16_t get_bucket(Data *data) {
+    log_func();
+    if (data->goal <= 0) return 0;
+    int32_t percent = data->steps * 100 / data->goal;
+    return percent > 100 ? 100 : percent;
+}
+
+static void health_handler(HealthEventType event, void *context) {
+    log_func();
+    Data *data = ring_layer_get_data(context);
+    if (event == HealthEventSignificantUpdate || time_start_of_today() != data->today) {
+        update_goal(data);
+    } else if (event != HealthEventMovementUpdate) {
+        return;
+    }
+    data->steps = sum_today(HealthMetricStepCount);
+
+    int16_t bucket = get_bucket(data);
+    if (bucket != data->bucket) {
+        data->bucket = bucket;
+        ring_layer_animate_to(context, bucket);
+    }
+}
+
+static void focus_handler(void *context) {
+    log_func();
+    Data *data = ring_layer_get_data(context);
+    ring_layer_set_value(context, data->bucket);
+}
+
+StepsLayer *steps_layer_create(GRect frame) {
+    log_func();
+    StepsLayer *this = ring_layer_create(frame, &ring, sizeof(Data));
+    Data *data = ring_layer_get_data(this);
+
+    update_goal(data);
+    data->steps = sum_today(HealthMetricStepCount);
+    data->bucket = get_bucket(data);
+    ring_layer_set_value(this, data->bucket);
+    data->health_event_handle = events_health_service_events_subscribe(health_handler, this);
+    data->focus_handle = focus_subscribe(focus_handler, this);
+
+    return this;
+}
+
+void steps_layer_destroy(StepsLayer *this) {
+    log_func();
+    Data *data = ring_layer_get_data(this);
+    focus_unsubscribe(data->focus_handle);
+    events_health_service_events_unsubscribe(data->health_event_handle);
+    ring_layer_destroy(this);
+}
+#endif